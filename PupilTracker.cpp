@@ -8,6 +8,7 @@
 ***********************************************************************************************************************/
 
 #include "PupilTracker.h"
+#include "RunLengthMask.h"
 #include "opencv2/opencv.hpp"
 #include <iostream>
 
@@ -122,7 +123,9 @@ bool PupilTracker::findPupil(const cv::Mat& eyeImage)
     cv::Mat darkMask;
     cv::inRange(imageGray, cv::InputArray(rangeMin), cv::InputArray(lowestSpike + m_pupilIntensityOffset), darkMask);
     const cv::Mat morphKernel = getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(7, 7));
-    cv::dilate(darkMask, darkMask, morphKernel, cv::Point(-1, -1), 2);
+    RunLengthMask darkRuns(darkMask);
+    darkRuns.dilate(morphKernel, cv::Point(-1, -1), 2);
+    darkRuns.decode(darkMask);
     if(m_display)
     {
 		images.push_back(darkMask);
@@ -134,7 +137,9 @@ bool PupilTracker::findPupil(const cv::Mat& eyeImage)
     // create a mask for the light glint area (assign black to glint area)
     cv::Mat glintMask;
     cv::inRange(imageGray, cv::InputArray(rangeMin), cv::InputArray(highestSpike - m_glintIntensityOffset), glintMask);
-    cv::erode(glintMask, glintMask, morphKernel, cv::Point(-1, -1), 1);
+    RunLengthMask glintRuns(glintMask);
+    glintRuns.erode(morphKernel, cv::Point(-1, -1), 1);
+    glintRuns.decode(glintMask);
     if(m_display)
     {
 		images.push_back(glintMask);
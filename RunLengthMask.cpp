@@ -0,0 +1,281 @@
+/*******************************************************************************************************************//**
+* @file RunLengthMask.cpp
+* @brief Implementation for the RunLengthMask class
+*
+* This class encapsulates run-length based binary morphology for tracker masks
+*
+***********************************************************************************************************************/
+
+#include "RunLengthMask.h"
+#include "opencv2/opencv.hpp"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+/*******************************************************************************************************************//**
+* @brief Constructor to create an empty RunLengthMask
+***********************************************************************************************************************/
+RunLengthMask::RunLengthMask()
+{
+    m_rows = 0;
+    m_cols = 0;
+    m_rowStart.assign(1, 0);
+}
+
+/*******************************************************************************************************************//**
+* @brief Constructor to create a RunLengthMask from a binary mask image
+* @param[in] mask single channel 8 bit mask, non-zero pixels are treated as set
+***********************************************************************************************************************/
+RunLengthMask::RunLengthMask(const cv::Mat& mask)
+{
+    encode(mask);
+}
+
+/*******************************************************************************************************************//**
+* @brief Convert a binary mask image into row runs
+* @param[in] mask single channel 8 bit mask, non-zero pixels are treated as set
+***********************************************************************************************************************/
+void RunLengthMask::encode(const cv::Mat& mask)
+{
+    CV_Assert(mask.type() == CV_8UC1);
+
+    m_rows = mask.rows;
+    m_cols = mask.cols;
+    m_runs.clear();
+    m_rowStart.resize(m_rows + 1);
+    m_rowStart[0] = 0;
+
+    for(int y = 0; y < m_rows; y++)
+    {
+        const uchar* row = mask.ptr<uchar>(y);
+        int x = 0;
+        while(x < m_cols)
+        {
+            // skip the unset pixels, then record the extent of the set pixels
+            while(x < m_cols && row[x] == 0)
+            {
+                x++;
+            }
+            if(x == m_cols)
+            {
+                break;
+            }
+            const int start = x;
+            while(x < m_cols && row[x] != 0)
+            {
+                x++;
+            }
+            m_runs.push_back(start);
+            m_runs.push_back(x);
+        }
+        m_rowStart[y + 1] = static_cast<int>(m_runs.size());
+    }
+}
+
+/*******************************************************************************************************************//**
+* @brief Convert the row runs back into a binary mask image
+* @param[out] mask single channel 8 bit mask with set pixels assigned 255 and all others 0
+***********************************************************************************************************************/
+void RunLengthMask::decode(cv::Mat& mask) const
+{
+    mask.create(m_rows, m_cols, CV_8UC1);
+
+    for(int y = 0; y < m_rows; y++)
+    {
+        uchar* row = mask.ptr<uchar>(y);
+        std::memset(row, 0, m_cols);
+        for(int i = m_rowStart[y]; i < m_rowStart[y + 1]; i += 2)
+        {
+            std::memset(row + m_runs[i], 255, m_runs[i + 1] - m_runs[i]);
+        }
+    }
+}
+
+/*******************************************************************************************************************//**
+* @brief Swap the set and unset pixels of the mask
+***********************************************************************************************************************/
+void RunLengthMask::invert()
+{
+    std::vector<int> runs;
+    std::vector<int> rowStart(m_rows + 1);
+    runs.reserve(m_runs.size() + 2 * m_rows);
+    rowStart[0] = 0;
+
+    for(int y = 0; y < m_rows; y++)
+    {
+        // the gaps between the existing runs become the new runs
+        int x = 0;
+        for(int i = m_rowStart[y]; i < m_rowStart[y + 1]; i += 2)
+        {
+            if(m_runs[i] > x)
+            {
+                runs.push_back(x);
+                runs.push_back(m_runs[i]);
+            }
+            x = m_runs[i + 1];
+        }
+        if(x < m_cols)
+        {
+            runs.push_back(x);
+            runs.push_back(m_cols);
+        }
+        rowStart[y + 1] = static_cast<int>(runs.size());
+    }
+
+    m_runs.swap(runs);
+    m_rowStart.swap(rowStart);
+}
+
+/*******************************************************************************************************************//**
+* @brief Dilate the mask, matching cv::dilate with the default constant border
+* @param[in] kernel structuring element, an empty kernel selects a 3x3 rectangle
+* @param[in] anchor position of the anchor within the element, (-1, -1) selects the element center
+* @param[in] iterations number of times the dilation is applied
+***********************************************************************************************************************/
+void RunLengthMask::dilate(const cv::Mat& kernel, cv::Point anchor, int iterations)
+{
+    if(iterations <= 0 || kernel.rows * kernel.cols == 1)
+    {
+        return;
+    }
+
+    std::vector<KernelSpan> spans;
+    getKernelSpans(kernel, anchor, spans);
+    for(int i = 0; i < iterations; i++)
+    {
+        dilateOnce(spans);
+    }
+}
+
+/*******************************************************************************************************************//**
+* @brief Erode the mask, matching cv::erode with the default constant border
+*
+* Pixels outside of the image never unset a pixel during erosion, just as they never set one during dilation, so the
+* erosion is computed as the dilation of the inverted mask.
+*
+* @param[in] kernel structuring element, an empty kernel selects a 3x3 rectangle
+* @param[in] anchor position of the anchor within the element, (-1, -1) selects the element center
+* @param[in] iterations number of times the erosion is applied
+***********************************************************************************************************************/
+void RunLengthMask::erode(const cv::Mat& kernel, cv::Point anchor, int iterations)
+{
+    if(iterations <= 0 || kernel.rows * kernel.cols == 1)
+    {
+        return;
+    }
+
+    invert();
+    dilate(kernel, anchor, iterations);
+    invert();
+}
+
+/*******************************************************************************************************************//**
+* @brief Decompose a structuring element into horizontal spans of non-zero elements
+* @param[in] kernel structuring element, an empty kernel selects a 3x3 rectangle
+* @param[in] anchor position of the anchor within the element, (-1, -1) selects the element center
+* @param[out] spans the element spans relative to the anchor
+***********************************************************************************************************************/
+void RunLengthMask::getKernelSpans(const cv::Mat& kernel, cv::Point anchor, std::vector<KernelSpan>& spans)
+{
+    cv::Mat element = kernel;
+    if(element.empty())
+    {
+        element = cv::Mat::ones(3, 3, CV_8UC1);
+        anchor = cv::Point(1, 1);
+    }
+    CV_Assert(element.type() == CV_8UC1);
+
+    if(anchor.x == -1)
+    {
+        anchor.x = element.cols / 2;
+    }
+    if(anchor.y == -1)
+    {
+        anchor.y = element.rows / 2;
+    }
+    CV_Assert(anchor.inside(cv::Rect(0, 0, element.cols, element.rows)));
+
+    spans.clear();
+    for(int i = 0; i < element.rows; i++)
+    {
+        const uchar* row = element.ptr<uchar>(i);
+        int j = 0;
+        while(j < element.cols)
+        {
+            while(j < element.cols && row[j] == 0)
+            {
+                j++;
+            }
+            if(j == element.cols)
+            {
+                break;
+            }
+            const int start = j;
+            while(j < element.cols && row[j] != 0)
+            {
+                j++;
+            }
+            KernelSpan span = {i - anchor.y, start - anchor.x, j - anchor.x};
+            spans.push_back(span);
+        }
+    }
+}
+
+/*******************************************************************************************************************//**
+* @brief Apply a single dilation pass using precomputed element spans
+*
+* Each output pixel is set when some element offset lands on a set source pixel, so a source run [s, e) combined with
+* an element span [a, b) sets the output columns [s - b + 1, e - a).
+*
+* @param[in] spans the element spans relative to the anchor
+***********************************************************************************************************************/
+void RunLengthMask::dilateOnce(const std::vector<KernelSpan>& spans)
+{
+    std::vector<int> runs;
+    std::vector<int> rowStart(m_rows + 1);
+    std::vector<std::pair<int, int> > candidates;
+    runs.reserve(m_runs.size());
+    rowStart[0] = 0;
+
+    for(int y = 0; y < m_rows; y++)
+    {
+        // gather the grown runs of every source row covered by the element
+        candidates.clear();
+        for(size_t k = 0; k < spans.size(); k++)
+        {
+            const int sy = y + spans[k].dy;
+            if(sy < 0 || sy >= m_rows)
+            {
+                continue;
+            }
+            for(int i = m_rowStart[sy]; i < m_rowStart[sy + 1]; i += 2)
+            {
+                const int start = std::max(m_runs[i] - spans[k].end + 1, 0);
+                const int end = std::min(m_runs[i + 1] - spans[k].start, m_cols);
+                if(start < end)
+                {
+                    candidates.push_back(std::make_pair(start, end));
+                }
+            }
+        }
+
+        // merge overlapping and touching runs
+        std::sort(candidates.begin(), candidates.end());
+        for(size_t i = 0; i < candidates.size(); i++)
+        {
+            if(runs.size() > static_cast<size_t>(rowStart[y]) && candidates[i].first <= runs.back())
+            {
+                runs.back() = std::max(runs.back(), candidates[i].second);
+            }
+            else
+            {
+                runs.push_back(candidates[i].first);
+                runs.push_back(candidates[i].second);
+            }
+        }
+        rowStart[y + 1] = static_cast<int>(runs.size());
+    }
+
+    m_runs.swap(runs);
+    m_rowStart.swap(rowStart);
+}
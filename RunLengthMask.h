@@ -0,0 +1,65 @@
+/*******************************************************************************************************************//**
+* @file RunLengthMask.h
+* @brief Header for the RunLengthMask class
+*
+* This class encapsulates run-length based binary morphology for tracker masks
+*
+***********************************************************************************************************************/
+
+#ifndef RUN_LENGTH_MASK_H
+#define RUN_LENGTH_MASK_H
+
+#include "opencv2/opencv.hpp"
+#include <vector>
+
+/**********************************************************************************************************************
+* @class RunLengthMask
+*
+* @brief Binary mask stored as per-row runs of set pixels
+*
+* Dilation and erosion grow or shrink the runs by the spans of each structuring element row, so their cost scales
+* with the number of mask boundaries rather than the number of pixels. Results are identical to cv::dilate and
+* cv::erode with the default constant border on a mask of zero and non-zero pixels (set pixels decode to 255).
+*
+***********************************************************************************************************************/
+class RunLengthMask
+{
+private:
+
+    // mask dimensions
+    int m_rows;
+    int m_cols;
+
+    // half-open [start, end) column pairs of set pixels, row y occupies m_runs[m_rowStart[y] .. m_rowStart[y + 1])
+    std::vector<int> m_runs;
+    std::vector<int> m_rowStart;
+
+    // structuring element rows as half-open [start, end) column offsets relative to the anchor
+    struct KernelSpan
+    {
+        int dy;
+        int start;
+        int end;
+    };
+
+    // internal helpers
+    static void getKernelSpans(const cv::Mat& kernel, cv::Point anchor, std::vector<KernelSpan>& spans);
+    void dilateOnce(const std::vector<KernelSpan>& spans);
+
+public:
+
+    // constructors
+    RunLengthMask();
+    explicit RunLengthMask(const cv::Mat& mask);
+
+    // conversion
+    void encode(const cv::Mat& mask);
+    void decode(cv::Mat& mask) const;
+
+    // morphology
+    void invert();
+    void dilate(const cv::Mat& kernel, cv::Point anchor = cv::Point(-1, -1), int iterations = 1);
+    void erode(const cv::Mat& kernel, cv::Point anchor = cv::Point(-1, -1), int iterations = 1);
+};
+
+#endif // RUN_LENGTH_MASK_H